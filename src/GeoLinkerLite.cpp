@@ -54,6 +54,12 @@ void GeoLinkerLite::setTimeOffset(int8_t hours, int8_t minutes) {
     _offsetHour = hours;
     _offsetMin = minutes;
 }
+void GeoLinkerLite::setGeofences(const GeoFence* fences, uint8_t count) {
+    _geofences = fences;
+    _geofenceCount = (count > MAX_GEOFENCES) ? MAX_GEOFENCES : count;
+}
+void GeoLinkerLite::setGeofenceHeartbeat(uint16_t minutes) { _geofenceHeartbeat = minutes; }
+void GeoLinkerLite::setCellFallbackTimeout(uint16_t seconds) { _cellFallbackTimeout = seconds; }
 
 void GeoLinkerLite::begin() {
     pinMode(_resetPin, INPUT);
@@ -128,7 +134,7 @@ void GeoLinkerLite::readStringWithLengthFromEEPROM(int address, char* buffer, in
     debugPrint("Read string '" + String(buffer) + "' from addr " + String(address) + " with length " + String(storedLength), DEBUG_VERBOSE);
 }
 
-void GeoLinkerLite::saveGPSDataToEEPROM(float lat, float lon, const char* timestamp) {
+void GeoLinkerLite::saveGPSDataToEEPROM(float lat, float lon, const char* timestamp, uint8_t source) {
     // Convert coordinates to strings with 6 decimal precision
     char latStr[LAT_STR_LENGTH];
     char lonStr[LON_STR_LENGTH];
@@ -140,7 +146,8 @@ void GeoLinkerLite::saveGPSDataToEEPROM(float lat, float lon, const char* timest
     writeStringWithLengthToEEPROM(EEPROM_LAT_ADDR, latStr, LAT_STR_LENGTH);
     writeStringWithLengthToEEPROM(EEPROM_LON_ADDR, lonStr, LON_STR_LENGTH);
     writeStringWithLengthToEEPROM(EEPROM_TIME_ADDR, timestamp, TIME_STR_LENGTH);
-    EEPROM.write(EEPROM_FLAG_ADDR, GPS_READY_FLAG);
+    EEPROM.write(EEPROM_SOURCE_ADDR, source);
+    EEPROM.write(EEPROM_FLAG_ADDR, GPS_READY_FLAG); // Ready flag last, record is complete
     
     debugPrint("Saved to EEPROM - Lat: " + String(latStr) + " Lon: " + String(lonStr) + " Time: " + String(timestamp), DEBUG_BASIC);
 }
@@ -151,12 +158,21 @@ void GeoLinkerLite::readGPSDataFromEEPROM(char* latStr, char* lonStr, char* time
     readStringWithLengthFromEEPROM(EEPROM_TIME_ADDR, timestamp, TIME_STR_LENGTH);
 }
 
+void GeoLinkerLite::saveCellDataToEEPROM(uint16_t accuracy, const char* cellInfo) {
+    EEPROM.put(EEPROM_ACCURACY_ADDR, accuracy);
+    writeStringWithLengthToEEPROM(EEPROM_CELL_ADDR, cellInfo, CELL_STR_LENGTH);
+    
+    debugPrint("Saved cell data - Accuracy: " + String(accuracy) + "m Cell: " + String(cellInfo), DEBUG_BASIC);
+}
+
 void GeoLinkerLite::clearEEPROMData() {
     EEPROM.write(EEPROM_FLAG_ADDR, 0x00);
     // Clear GPS data including length bytes
     for (int i = EEPROM_LAT_ADDR; i < EEPROM_TIME_ADDR + TIME_STR_LENGTH + 1; i++) {
         EEPROM.write(i, 0x00);
     }
+    EEPROM.write(EEPROM_SOURCE_ADDR, LOCATION_SOURCE_GPS);
+    EEPROM.write(EEPROM_FENCE_PENDING_FLAG_ADDR, 0x00);
     debugPrint_P(PSTR("EEPROM data cleared including length bytes"), DEBUG_VERBOSE);
 }
 
@@ -235,6 +251,14 @@ bool GeoLinkerLite::parseNMEA(const char* line, float& lat, float& lon, char* ti
     uint8_t mm = (timeStr[2] - '0') * 10 + (timeStr[3] - '0');
     uint8_t ss = (timeStr[4] - '0') * 10 + (timeStr[5] - '0');
     
+    formatTimestamp(year, month, day, hh, mm, ss, timestamp);
+    _fixMinutes = minutesSince2000(year, month, day, hh, mm);
+    
+    debugPrint("GPS: Lat=" + String(lat, 6) + " Lon=" + String(lon, 6), DEBUG_BASIC);
+    return true;
+}
+
+void GeoLinkerLite::formatTimestamp(uint8_t year, uint8_t month, uint8_t day, uint8_t hh, uint8_t mm, uint8_t ss, char* timestamp) {
     // Apply time offset
     int totalMin = hh * 60 + mm + _offsetHour * 60 + _offsetMin;
     if (totalMin < 0) totalMin += 24 * 60;
@@ -245,9 +269,16 @@ bool GeoLinkerLite::parseNMEA(const char* line, float& lat, float& lon, char* ti
     
     // Format timestamp
     snprintf(timestamp, 20, "20%02d-%02d-%02d %02d:%02d:%02d", year, month, day, hh, mm, ss);
-    
-    debugPrint("GPS: Lat=" + String(lat, 6) + " Lon=" + String(lon, 6), DEBUG_BASIC);
-    return true;
+}
+
+uint32_t GeoLinkerLite::minutesSince2000(uint8_t year, uint8_t month, uint8_t day, uint8_t hh, uint8_t mm) {
+    // UTC minutes since 2000-01-01, used for the geofence heartbeat
+    static const uint16_t daysBeforeMonth[12] PROGMEM = {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
+    if (month < 1 || month > 12) return 0;
+    
+    uint32_t days = (uint32_t)year * 365 + (year + 3) / 4 + pgm_read_word(&daysBeforeMonth[month - 1]) + day - 1;
+    if (month > 2 && (year % 4) == 0) days++;
+    return days * 1440UL + hh * 60 + mm;
 }
 
 void GeoLinkerLite::handleGPSMode() {
@@ -268,7 +299,11 @@ void GeoLinkerLite::handleGPSMode() {
     uint8_t gpsBufferIndex = 0;
     bool gpsDataValid = false;
     unsigned long startTime = millis();
-    const unsigned long gpsTimeout = 300000; // 5 minutes timeout
+    unsigned long gpsTimeout = 300000; // 5 minutes timeout
+    bool useCellFallback = cellFallbackActive();
+    if (useCellFallback) {
+        gpsTimeout = _cellFallbackTimeout * 1000UL; // Give up early, cell fallback follows
+    }
     
     while (!gpsDataValid && (millis() - startTime < gpsTimeout)) {
         while (_gpsSerial->available()) {
@@ -285,9 +320,13 @@ void GeoLinkerLite::handleGPSMode() {
                     char timestamp[20];
                     
                     if (parseNMEA(lastValidGPRMC, lat, lon, timestamp)) {
-                        // Save to EEPROM as strings
-                        saveGPSDataToEEPROM(lat, lon, timestamp);
-                        debugPrint_P(PSTR("GPS data saved to EEPROM"), DEBUG_BASIC);
+                        if (_geofenceCount > 0 && !geofenceShouldReport(lat, lon)) {
+                            debugPrint_P(PSTR("No geofence event, upload skipped"), DEBUG_BASIC);
+                        } else {
+                            // Save to EEPROM as strings
+                            saveGPSDataToEEPROM(lat, lon, timestamp);
+                            debugPrint_P(PSTR("GPS data saved to EEPROM"), DEBUG_BASIC);
+                        }
                         gpsDataValid = true;
                         break;
                     }
@@ -312,6 +351,9 @@ void GeoLinkerLite::handleGPSMode() {
     
     if (!gpsDataValid) {
         debugPrint_P(PSTR("GPS timeout - no valid data received"), DEBUG_BASIC);
+        if (useCellFallback) {
+            handleCellFallback();
+        }
     }
     
     // Wait and trigger reset
@@ -321,6 +363,185 @@ void GeoLinkerLite::handleGPSMode() {
     digitalWrite(_resetPin, LOW);
 }
 
+// ========================================
+// GEOFENCE FUNCTIONS
+// ========================================
+bool GeoLinkerLite::geofenceContains(const GeoFence& fence, int32_t lat, int32_t lon, int32_t cosLatQ15, uint16_t invCosLatQ8) {
+    if (fence.type == GEOFENCE_TYPE_CIRCLE) {
+        // Radius in microdegrees of latitude (1 m ~= 8.983 udeg)
+        uint32_t radius = (fence.radius > GEOFENCE_MAX_RADIUS) ? GEOFENCE_MAX_RADIUS : fence.radius;
+        int32_t span = (int32_t)((radius * 8983UL) / 1000UL);
+        
+        // Bounding-box reject in raw microdegrees, 32-bit only
+        int32_t dy = lat - fence.minLat;
+        if (dy > span || dy < -span) return false;
+        
+        // Wrap across the antimeridian
+        int32_t dLon = lon - fence.minLon;
+        if (dLon > 180000000L) dLon -= 360000000L;
+        else if (dLon < -180000000L) dLon += 360000000L;
+        int32_t lonSpan = (int32_t)(((uint32_t)span * invCosLatQ8) >> 8);
+        if (dLon > lonSpan || dLon < -lonSpan) return false;
+        
+        // Inside the box: scale longitude and do the exact radius test
+        int32_t dx = (int32_t)(((int64_t)dLon * cosLatQ15) >> 15);
+        return ((int64_t)dx * dx + (int64_t)dy * dy) <= (int64_t)span * span;
+    }
+    
+    // Polygon: bounding-box reject, then even-odd ray cast
+    if (lat < fence.minLat || lat > fence.maxLat || lon < fence.minLon || lon > fence.maxLon) {
+        return false;
+    }
+    if (fence.vertexCount < 3 || !fence.vertices) return false;
+    
+    bool inside = false;
+    uint8_t j = fence.vertexCount - 1;
+    int32_t jLat = (int32_t)pgm_read_dword(&fence.vertices[j * 2]);
+    int32_t jLon = (int32_t)pgm_read_dword(&fence.vertices[j * 2 + 1]);
+    
+    for (uint8_t i = 0; i < fence.vertexCount; i++) {
+        int32_t iLat = (int32_t)pgm_read_dword(&fence.vertices[i * 2]);
+        int32_t iLon = (int32_t)pgm_read_dword(&fence.vertices[i * 2 + 1]);
+        
+        if ((iLat > lat) != (jLat > lat)) {
+            // Cross-multiplied edge test, avoids division
+            int64_t lhs = (int64_t)(lon - iLon) * (jLat - iLat);
+            int64_t rhs = (int64_t)(jLon - iLon) * (lat - iLat);
+            if ((jLat > iLat) ? (lhs < rhs) : (lhs > rhs)) {
+                inside = !inside;
+            }
+        }
+        jLat = iLat;
+        jLon = iLon;
+    }
+    return inside;
+}
+
+bool GeoLinkerLite::geofenceShouldReport(float lat, float lon) {
+    int32_t fixLat = (int32_t)(lat * 1000000.0);
+    int32_t fixLon = (int32_t)(lon * 1000000.0);
+    
+    // Longitude scale for this latitude, computed once per fix.
+    // Clamped at ~85 degrees so the box stays finite near the poles.
+    float cosLat = cos(lat * DEG_TO_RAD);
+    if (cosLat < 0.0872) cosLat = 0.0872;
+    int32_t cosLatQ15 = (int32_t)(cosLat * 32768.0);
+    uint16_t invCosLatQ8 = (uint16_t)(256.0 / cosLat) + 1;
+    
+    uint32_t insideMask = 0;
+    for (uint8_t i = 0; i < _geofenceCount; i++) {
+        GeoFence fence;
+        memcpy_P(&fence, &_geofences[i], sizeof(GeoFence));
+        if (geofenceContains(fence, fixLat, fixLon, cosLatQ15, invCosLatQ8)) {
+            insideMask |= (1UL << i);
+        }
+    }
+    
+    uint32_t lastMask = 0;
+    uint32_t lastReport = 0;
+    bool stateValid = geofenceLoadState(lastMask, lastReport);
+    
+    bool report = false;
+    if (!stateValid) {
+        debugPrint_P(PSTR("Geofence: no previous state"), DEBUG_BASIC);
+        report = true;
+    } else if (insideMask != lastMask) {
+        uint32_t entered = insideMask & ~lastMask;
+        uint32_t exited = lastMask & ~insideMask;
+        debugPrint("Geofence: entered=0x" + String(entered, HEX) + " exited=0x" + String(exited, HEX), DEBUG_BASIC);
+        report = true;
+    } else if (_geofenceHeartbeat > 0 && (_fixMinutes - lastReport) >= _geofenceHeartbeat) {
+        debugPrint_P(PSTR("Geofence: heartbeat due"), DEBUG_BASIC);
+        report = true;
+    }
+    
+    if (report) {
+        geofenceSetPending(insideMask, _fixMinutes);
+    }
+    
+    debugPrint("Geofence mask: 0x" + String(insideMask, HEX), DEBUG_VERBOSE);
+    return report;
+}
+
+bool GeoLinkerLite::geofenceLoadState(uint32_t& mask, uint32_t& reportTime) {
+    // Last reported state survives resets in EEPROM, but only counts
+    // if it was saved for this exact fence table
+    uint8_t storedCount = EEPROM.read(EEPROM_FENCE_SIG_ADDR);
+    uint16_t storedSig = 0;
+    EEPROM.get(EEPROM_FENCE_SIG_ADDR + 1, storedSig);
+    if (EEPROM.read(EEPROM_FENCE_FLAG_ADDR) != FENCE_READY_FLAG ||
+        storedCount != _geofenceCount || storedSig != geofenceSignature()) {
+        return false;
+    }
+    
+    EEPROM.get(EEPROM_FENCE_STATE_ADDR, mask);
+    EEPROM.get(EEPROM_FENCE_REPORT_ADDR, reportTime);
+    return true;
+}
+
+bool GeoLinkerLite::geofenceHeartbeatDue(uint32_t utcMinutes) {
+    uint32_t mask = 0;
+    uint32_t lastReport = 0;
+    if (_geofenceHeartbeat == 0 || !geofenceLoadState(mask, lastReport)) return false;
+    return (utcMinutes - lastReport) >= _geofenceHeartbeat;
+}
+
+void GeoLinkerLite::geofenceSetPending(uint32_t mask, uint32_t reportTime) {
+    // New state stays pending until GSM mode confirms the upload
+    EEPROM.put(EEPROM_FENCE_PENDING_STATE_ADDR, mask);
+    EEPROM.put(EEPROM_FENCE_PENDING_REPORT_ADDR, reportTime);
+    EEPROM.write(EEPROM_FENCE_PENDING_FLAG_ADDR, FENCE_PENDING_FLAG);
+}
+
+uint16_t GeoLinkerLite::geofenceSignature() {
+    // Fletcher-style checksum over the fence fields and polygon vertices.
+    // The vertices pointer is left out, it changes whenever flash moves.
+    uint8_t sum1 = 0;
+    uint8_t sum2 = 0;
+    for (uint8_t i = 0; i < _geofenceCount; i++) {
+        GeoFence fence;
+        memcpy_P(&fence, &_geofences[i], sizeof(GeoFence));
+        
+        // type, vertexCount, then minLat..radius (contiguous 32-bit fields)
+        sum1 += fence.type;          sum2 += sum1;
+        sum1 += fence.vertexCount;   sum2 += sum1;
+        const uint8_t* data = (const uint8_t*)&fence.minLat;
+        for (uint8_t n = 0; n < 5 * sizeof(int32_t); n++) {
+            sum1 += data[n];
+            sum2 += sum1;
+        }
+        
+        if (fence.type == GEOFENCE_TYPE_POLYGON && fence.vertices) {
+            const uint8_t* vertexData = (const uint8_t*)fence.vertices;
+            uint16_t vertexLength = fence.vertexCount * 2 * sizeof(int32_t);
+            for (uint16_t n = 0; n < vertexLength; n++) {
+                sum1 += pgm_read_byte(&vertexData[n]);
+                sum2 += sum1;
+            }
+        }
+    }
+    return ((uint16_t)sum2 << 8) | sum1;
+}
+
+void GeoLinkerLite::geofenceCommitState() {
+    if (_geofenceCount == 0 || EEPROM.read(EEPROM_FENCE_PENDING_FLAG_ADDR) != FENCE_PENDING_FLAG) {
+        return;
+    }
+    
+    uint32_t mask = 0;
+    uint32_t reportTime = 0;
+    EEPROM.get(EEPROM_FENCE_PENDING_STATE_ADDR, mask);
+    EEPROM.get(EEPROM_FENCE_PENDING_REPORT_ADDR, reportTime);
+    
+    EEPROM.put(EEPROM_FENCE_STATE_ADDR, mask);
+    EEPROM.put(EEPROM_FENCE_REPORT_ADDR, reportTime);
+    EEPROM.write(EEPROM_FENCE_SIG_ADDR, _geofenceCount);
+    EEPROM.put(EEPROM_FENCE_SIG_ADDR + 1, geofenceSignature());
+    EEPROM.write(EEPROM_FENCE_FLAG_ADDR, FENCE_READY_FLAG);
+    
+    debugPrint("Geofence state committed: 0x" + String(mask, HEX), DEBUG_VERBOSE);
+}
+
 // ========================================
 // GSM FUNCTIONS
 // ========================================
@@ -469,6 +690,184 @@ finish:
     return (httpStatus >= 200 && httpStatus < 300);
 }
 
+bool GeoLinkerLite::modemCellLocation(float& lat, float& lon, uint16_t& accuracy, char* timestamp, uint32_t& utcMinutes, char* cellInfo) {
+    debugPrint_P(PSTR("Requesting cell location..."), DEBUG_BASIC);
+    
+    // 1. Serving cell: +CENG: 0,"arfcn,rxl,rxq,mcc,mnc,bsic,cellid,rla,txp,lac,TA"
+    cellInfo[0] = '\0';
+    modemSendAT("AT+CENG=1,1", modem_cmdTimeout, "OK");
+    String resp = modemSendAT("AT+CENG?", modem_cmdTimeout, "OK");
+    modemSendAT("AT+CENG=0", modem_cmdTimeout, "OK");
+    
+    int idx = resp.indexOf("+CENG: 0,\"");
+    if (idx != -1) {
+        // Locate the commas ending fields 0..9 without copying the line
+        int lineEnd = resp.indexOf('"', idx + 10);
+        int commas[10];
+        uint8_t found = 0;
+        int pos = idx + 9;
+        while (found < 10) {
+            pos = resp.indexOf(',', pos + 1);
+            if (pos == -1 || lineEnd == -1 || pos > lineEnd) break;
+            commas[found++] = pos;
+        }
+        
+        if (found == 10) {
+            // MCC-MNC-LAC-CellID
+            static const uint8_t wanted[4] = {3, 4, 9, 6};
+            uint8_t len = 0;
+            bool complete = true;
+            for (uint8_t f = 0; f < 4 && complete; f++) {
+                int start = commas[wanted[f] - 1] + 1;
+                int end = commas[wanted[f]];
+                if (end <= start) complete = false;
+                if (f > 0 && len < CELL_STR_LENGTH - 1) cellInfo[len++] = '-';
+                for (int i = start; i < end && len < CELL_STR_LENGTH - 1; i++) {
+                    cellInfo[len++] = resp[i];
+                }
+            }
+            cellInfo[complete ? len : 0] = '\0';
+        }
+    }
+    if (cellInfo[0] == '\0') {
+        debugPrint_P(PSTR("Serving cell info unavailable"), DEBUG_BASIC);
+    }
+    
+    // 2. Network location from serving and neighbor cells, needs a bearer
+    modemSendAT("AT+SAPBR=3,1,\"Contype\",\"GPRS\"", modem_cmdTimeout, "OK");
+    modemSendAT("AT+SAPBR=3,1,\"APN\",\"" + String(_modemAPN) + "\"", modem_cmdTimeout, "OK");
+    modemSendAT("AT+SAPBR=1,1", modem_httpTimeout, "OK");
+    
+    // +CLBS: 0,<lon>,<lat>,<accuracy>,<yy/mm/dd>,<hh:mm:ss>
+    resp = modemSendAT("AT+CLBS=4,1", modem_clbsTimeout, "OK");
+    modemSendAT("AT+SAPBR=0,1", modem_cmdTimeout, "OK");
+    
+    idx = resp.indexOf("+CLBS: ");
+    if (idx == -1 || resp.substring(idx + 7, idx + 8).toInt() != 0) {
+        debugPrint_P(PSTR("Cell location unavailable"), DEBUG_BASIC);
+        return false;
+    }
+    
+    int p1 = resp.indexOf(',', idx);
+    int p2 = resp.indexOf(',', p1 + 1);
+    int p3 = resp.indexOf(',', p2 + 1);
+    int p4 = resp.indexOf(',', p3 + 1);
+    int p5 = resp.indexOf(',', p4 + 1);
+    if (p1 == -1 || p2 == -1 || p3 == -1 || p4 == -1 || p5 == -1 ||
+        p5 - p4 != 9 || p5 + 8 >= (int)resp.length()) {
+        debugPrint_P(PSTR("Cell location format invalid"), DEBUG_BASIC);
+        return false;
+    }
+    
+    lon = resp.substring(p1 + 1, p2).toFloat();
+    lat = resp.substring(p2 + 1, p3).toFloat();
+    accuracy = resp.substring(p3 + 1, p4).toInt();
+    
+    // yy/mm/dd at p4 + 1, hh:mm:ss at p5 + 1 (UTC)
+    uint8_t year = (resp[p4 + 1] - '0') * 10 + (resp[p4 + 2] - '0');
+    uint8_t month = (resp[p4 + 4] - '0') * 10 + (resp[p4 + 5] - '0');
+    uint8_t day = (resp[p4 + 7] - '0') * 10 + (resp[p4 + 8] - '0');
+    uint8_t hh = (resp[p5 + 1] - '0') * 10 + (resp[p5 + 2] - '0');
+    uint8_t mm = (resp[p5 + 4] - '0') * 10 + (resp[p5 + 5] - '0');
+    uint8_t ss = (resp[p5 + 7] - '0') * 10 + (resp[p5 + 8] - '0');
+    
+    formatTimestamp(year, month, day, hh, mm, ss, timestamp);
+    utcMinutes = minutesSince2000(year, month, day, hh, mm);
+    
+    debugPrint("Cell: Lat=" + String(lat, 6) + " Lon=" + String(lon, 6) + " Acc=" + String(accuracy) + "m", DEBUG_BASIC);
+    return true;
+}
+
+bool GeoLinkerLite::modemNetworkTime(uint32_t& utcMinutes) {
+    // Network time (NITZ) keeps the modem clock set without a data session
+    modemSendAT("AT+CLTS=1", modem_cmdTimeout, "OK");
+    
+    // +CCLK: "yy/MM/dd,hh:mm:ss+zz", zz in quarter hours
+    String resp = modemSendAT("AT+CCLK?", modem_cmdTimeout, "OK");
+    int idx = resp.indexOf("+CCLK: \"");
+    if (idx == -1 || idx + 28 > (int)resp.length()) return false;
+    
+    int p = idx + 8;
+    if (resp[p + 2] != '/' || resp[p + 8] != ',' || resp[p + 11] != ':') return false;
+    
+    uint8_t year = (resp[p] - '0') * 10 + (resp[p + 1] - '0');
+    uint8_t month = (resp[p + 3] - '0') * 10 + (resp[p + 4] - '0');
+    uint8_t day = (resp[p + 6] - '0') * 10 + (resp[p + 7] - '0');
+    uint8_t hh = (resp[p + 9] - '0') * 10 + (resp[p + 10] - '0');
+    uint8_t mm = (resp[p + 12] - '0') * 10 + (resp[p + 13] - '0');
+    int8_t quarters = (resp[p + 18] - '0') * 10 + (resp[p + 19] - '0');
+    if (resp[p + 17] == '-') quarters = -quarters;
+    
+    // An unsynced clock reports its power-on default (e.g. 04/01/01)
+    if (year < 20) {
+        debugPrint_P(PSTR("Modem clock not synced to network time"), DEBUG_BASIC);
+        return false;
+    }
+    
+    utcMinutes = minutesSince2000(year, month, day, hh, mm) - quarters * 15L;
+    debugPrint("Network time: " + String(utcMinutes) + " min", DEBUG_VERBOSE);
+    return true;
+}
+
+bool GeoLinkerLite::cellFallbackActive() {
+    if (_cellFallbackTimeout == 0) return false;
+    if (_geofenceCount == 0) return true;
+    
+    // With geofences, a cell record only stands in for a due heartbeat,
+    // which needs a heartbeat interval and a GPS baseline
+    uint32_t mask = 0;
+    uint32_t lastReport = 0;
+    return _geofenceHeartbeat > 0 && geofenceLoadState(mask, lastReport);
+}
+
+void GeoLinkerLite::handleCellFallback() {
+    debugPrint_P(PSTR("Cell fallback: Querying modem..."), DEBUG_BASIC);
+    
+    // Allocate GSM resources
+    SoftwareSerial* modemSerial = new SoftwareSerial(_gsmRxPin, _gsmTxPin);
+    modemSerial->begin(9600);
+    _modemSerial = modemSerial;
+    
+    float lat, lon;
+    uint16_t accuracy = 0;
+    uint32_t utcMinutes = 0;
+    uint32_t mask = 0;
+    uint32_t lastReport = 0;
+    char timestamp[TIME_STR_LENGTH];
+    char cellInfo[CELL_STR_LENGTH];
+    
+    bool wanted = checkNetworkRegistration();
+    if (wanted && _geofenceCount > 0) {
+        // Decide on the heartbeat from the modem clock before opening a
+        // data bearer for CLBS
+        uint32_t now = 0;
+        geofenceLoadState(mask, lastReport);
+        if (!modemNetworkTime(now)) {
+            debugPrint_P(PSTR("No network time, cell record skipped"), DEBUG_BASIC);
+            wanted = false;
+        } else if (!geofenceHeartbeatDue(now)) {
+            debugPrint_P(PSTR("Geofence heartbeat not due, cell record skipped"), DEBUG_BASIC);
+            wanted = false;
+        }
+    }
+    
+    if (wanted && modemCellLocation(lat, lon, accuracy, timestamp, utcMinutes, cellInfo)) {
+        if (_geofenceCount > 0) {
+            // Fence state is unknown, only the heartbeat timer moves on
+            geofenceSetPending(mask, utcMinutes);
+        }
+        // Cell fields first, ready flag last
+        saveCellDataToEEPROM(accuracy, cellInfo);
+        saveGPSDataToEEPROM(lat, lon, timestamp, LOCATION_SOURCE_CELL);
+    } else if (wanted) {
+        debugPrint_P(PSTR("Cell fallback failed, nothing recorded"), DEBUG_BASIC);
+    }
+    
+    // Clean up GSM resources
+    delete modemSerial;
+    _modemSerial = nullptr;
+}
+
 void GeoLinkerLite::handleGSMMode() {
     debugPrint_P(PSTR("GSM Mode: Sending data to server..."), DEBUG_BASIC);
     
@@ -494,6 +893,19 @@ void GeoLinkerLite::handleGSMMode() {
     json += "\"lat\":[" + String(lat, 6) + "],";  // Array format with 6 decimal places
     json += "\"long\":[" + String(lon, 6) + "],"; // Array format with 6 decimal places
     json += "\"timestamp\":[\"" + String(timestamp) + "\"]";  // Array format for timestamp
+    
+    // Tag coarse cell-tower records so the backend can tell them apart
+    if (EEPROM.read(EEPROM_SOURCE_ADDR) == LOCATION_SOURCE_CELL) {
+        uint16_t accuracy;
+        char cellInfo[CELL_STR_LENGTH];
+        EEPROM.get(EEPROM_ACCURACY_ADDR, accuracy);
+        readStringWithLengthFromEEPROM(EEPROM_CELL_ADDR, cellInfo, CELL_STR_LENGTH);
+        json += ",\"source\":[\"cell\"]";
+        json += ",\"accuracy\":[" + String(accuracy) + "]";
+        if (cellInfo[0] != '\0') {
+            json += ",\"cell\":[\"" + String(cellInfo) + "\"]";
+        }
+    }
     json += "}";
     
     debugPrint("JSON: " + json, DEBUG_VERBOSE);
@@ -545,6 +957,8 @@ void GeoLinkerLite::handleGSMMode() {
     // Print final result
     if (success) {
         debugPrint_P(PSTR("SUCCESS: Data transmission completed"), DEBUG_BASIC);
+        // Geofence event was delivered, it becomes the new baseline
+        geofenceCommitState();
     } else {
         debugPrint("FAILED: " + lastError + " (Max retries reached)", DEBUG_BASIC);
     }
@@ -41,6 +41,33 @@
 #include <EEPROM.h>
 #include <avr/pgmspace.h>
 
+// Geofence types
+#define GEOFENCE_TYPE_CIRCLE  0
+#define GEOFENCE_TYPE_POLYGON 1
+
+// Larger circle radii are clamped to this (metres)
+#define GEOFENCE_MAX_RADIUS   100000UL
+
+// Geofence definition, stored in PROGMEM. Coordinates are in microdegrees
+// (degrees * 1000000). Circles use minLat/minLon as the centre and ignore
+// maxLat/maxLon; polygons supply their bounding box for the early reject.
+// Circles may straddle the +/-180 degree line, polygons must not.
+struct GeoFence {
+    uint8_t type;             // GEOFENCE_TYPE_CIRCLE or GEOFENCE_TYPE_POLYGON
+    uint8_t vertexCount;      // Polygon vertex count (0 for circles)
+    int32_t minLat;
+    int32_t minLon;
+    int32_t maxLat;
+    int32_t maxLon;
+    uint32_t radius;          // Circle radius in metres, up to GEOFENCE_MAX_RADIUS (0 for polygons)
+    const int32_t* vertices;  // Polygon lat/lon pairs in PROGMEM
+};
+
+#define GEOFENCE_CIRCLE(lat, lon, radiusM) \
+    { GEOFENCE_TYPE_CIRCLE, 0, (lat), (lon), (lat), (lon), (radiusM), NULL }
+#define GEOFENCE_POLYGON(vertices, count, minLat, minLon, maxLat, maxLon) \
+    { GEOFENCE_TYPE_POLYGON, (count), (minLat), (minLon), (maxLat), (maxLon), 0, (vertices) }
+
 class GeoLinkerLite {
   public:
     // Constructor
@@ -55,6 +82,9 @@ class GeoLinkerLite {
     void setMaxRetries(uint8_t retries);
     void setDebugLevel(uint8_t level);
     void setTimeOffset(int8_t hours, int8_t minutes);
+    void setGeofences(const GeoFence* fences, uint8_t count);
+    void setGeofenceHeartbeat(uint16_t minutes);
+    void setCellFallbackTimeout(uint16_t seconds);
     
     // Main functions
     void begin();
@@ -72,19 +102,41 @@ class GeoLinkerLite {
     uint8_t _debugLevel = 2; // DEBUG_VERBOSE by default
     int8_t _offsetHour = 5;
     int8_t _offsetMin = 30;
+    const GeoFence* _geofences = NULL;
+    uint8_t _geofenceCount = 0;
+    uint16_t _geofenceHeartbeat = 0;
+    uint32_t _fixMinutes = 0;
+    uint16_t _cellFallbackTimeout = 0;
     
     // Constants
     static const uint8_t EEPROM_FLAG_ADDR = 10;
     static const uint8_t EEPROM_LAT_ADDR = 20;
     static const uint8_t EEPROM_LON_ADDR = 33;
     static const uint8_t EEPROM_TIME_ADDR = 46;
+    static const uint8_t EEPROM_FENCE_FLAG_ADDR = 70;
+    static const uint8_t EEPROM_FENCE_STATE_ADDR = 71;
+    static const uint8_t EEPROM_FENCE_REPORT_ADDR = 75;
+    static const uint8_t EEPROM_SOURCE_ADDR = 80;
+    static const uint8_t EEPROM_ACCURACY_ADDR = 81;
+    static const uint8_t EEPROM_CELL_ADDR = 83;
+    static const uint8_t EEPROM_FENCE_SIG_ADDR = 110;
+    static const uint8_t EEPROM_FENCE_PENDING_FLAG_ADDR = 113;
+    static const uint8_t EEPROM_FENCE_PENDING_STATE_ADDR = 114;
+    static const uint8_t EEPROM_FENCE_PENDING_REPORT_ADDR = 118;
     static const uint8_t GPS_READY_FLAG = 0x22;
+    static const uint8_t FENCE_READY_FLAG = 0x47;
+    static const uint8_t FENCE_PENDING_FLAG = 0x48;
+    static const uint8_t MAX_GEOFENCES = 32;
+    static const uint8_t LOCATION_SOURCE_GPS = 0;
+    static const uint8_t LOCATION_SOURCE_CELL = 1;
+    static const uint8_t CELL_STR_LENGTH = 24;
     static const uint8_t LAT_STR_LENGTH = 12;
     static const uint8_t LON_STR_LENGTH = 12;
     static const uint8_t TIME_STR_LENGTH = 20;
     static const uint16_t GPS_BUFFER_SIZE = 100;
     static const uint16_t modem_cmdTimeout = 5000;
     static const uint16_t modem_httpTimeout = 15000;
+    static const uint16_t modem_clbsTimeout = 30000;
     
     // Serial interfaces
     Stream* _debugSerial;
@@ -103,19 +155,35 @@ class GeoLinkerLite {
     // EEPROM functions
     void writeStringWithLengthToEEPROM(int address, const char* str, int maxLength);
     void readStringWithLengthFromEEPROM(int address, char* buffer, int maxLength);
-    void saveGPSDataToEEPROM(float lat, float lon, const char* timestamp);
+    void saveGPSDataToEEPROM(float lat, float lon, const char* timestamp, uint8_t source = LOCATION_SOURCE_GPS);
     void readGPSDataFromEEPROM(char* latStr, char* lonStr, char* timestamp);
+    void saveCellDataToEEPROM(uint16_t accuracy, const char* cellInfo);
     void clearEEPROMData();
     
     // GPS functions
     bool parseNMEA(const char* line, float& lat, float& lon, char* timestamp);
+    void formatTimestamp(uint8_t year, uint8_t month, uint8_t day, uint8_t hh, uint8_t mm, uint8_t ss, char* timestamp);
+    uint32_t minutesSince2000(uint8_t year, uint8_t month, uint8_t day, uint8_t hh, uint8_t mm);
     void handleGPSMode();
     
+    // Geofence functions
+    bool geofenceContains(const GeoFence& fence, int32_t lat, int32_t lon, int32_t cosLatQ15, uint16_t invCosLatQ8);
+    bool geofenceShouldReport(float lat, float lon);
+    bool geofenceLoadState(uint32_t& mask, uint32_t& reportTime);
+    bool geofenceHeartbeatDue(uint32_t utcMinutes);
+    void geofenceSetPending(uint32_t mask, uint32_t reportTime);
+    uint16_t geofenceSignature();
+    void geofenceCommitState();
+    
     // GSM functions
     String modemSendAT(const String& cmd, uint32_t timeout, const char* expect);
     bool checkNetworkRegistration();
     bool checkGprsContext();
     bool modemHttpPost(const String& json, int& httpStatus, String& httpResponse);
+    bool modemCellLocation(float& lat, float& lon, uint16_t& accuracy, char* timestamp, uint32_t& utcMinutes, char* cellInfo);
+    bool modemNetworkTime(uint32_t& utcMinutes);
+    bool cellFallbackActive();
+    void handleCellFallback();
     void handleGSMMode();
 };
 